@@ -7,32 +7,474 @@
 #include <algorithm>
 #include <cctype>
 #include <set>
+#include <unordered_map>
+#include <deque>
+#include <queue>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <cstdlib>
+#include <string_view>
+#include <memory_resource>
+#include <optional>
+#include <cstdint>
+#include <cstring>
+
+#include "unicode_tables.h"
 
 using namespace std;
 
+// Build with -DCOUNT_ALLOCATIONS to count every heap allocation and report
+// allocations/bytes per row at the end of analyzeCSV. Growth of the result
+// (new vocabulary terms, class statistics entries) is reported separately;
+// the remaining per-row temporaries of the rows after the first batch must
+// stay within MAX_ALLOCS_PER_ROW / MAX_BYTES_PER_ROW (both can be overridden
+// with -D), otherwise the program exits with status 1.
+#ifdef COUNT_ALLOCATIONS
+#include <new>
+
+#ifndef MAX_ALLOCS_PER_ROW
+#define MAX_ALLOCS_PER_ROW 0.1
+#endif
+#ifndef MAX_BYTES_PER_ROW
+#define MAX_BYTES_PER_ROW 16.0
+#endif
+
+#if defined(_MSC_VER)
+#define ALLOC_NOINLINE __declspec(noinline)
+#else
+#define ALLOC_NOINLINE __attribute__((noinline))
+#endif
+
+static size_t g_allocCount = 0;
+static size_t g_allocBytes = 0;
+static size_t g_resultAllocCount = 0;
+static size_t g_resultAllocBytes = 0;
+static bool g_allocBudgetExceeded = false;
+
+// All replaced new/delete overloads go through these two. Every block keeps
+// the malloc pointer just before the (possibly over-aligned) address handed
+// out, so plain and aligned deletes share one free path.
+ALLOC_NOINLINE static void* countedAlloc(size_t size, size_t align) noexcept {
+    g_allocCount++;
+    g_allocBytes += size;
+    align = max(align, alignof(max_align_t));
+    char* raw = (char*)malloc(size + align + sizeof(void*));
+    if(!raw) return nullptr;
+    uintptr_t aligned = ((uintptr_t)(raw + sizeof(void*)) + align - 1) & ~(uintptr_t)(align - 1);
+    ((void**)aligned)[-1] = raw;
+    return (void*)aligned;
+}
+
+ALLOC_NOINLINE static void countedFree(void* p) noexcept {
+    if(p) free(((void**)p)[-1]);
+}
+
+ALLOC_NOINLINE static void* countedAllocOrThrow(size_t size, size_t align) {
+    if(void* p = countedAlloc(size, align)) return p;
+    throw bad_alloc();
+}
+
+void* operator new(size_t size) { return countedAllocOrThrow(size, 0); }
+void* operator new[](size_t size) { return countedAllocOrThrow(size, 0); }
+void* operator new(size_t size, align_val_t align) { return countedAllocOrThrow(size, (size_t)align); }
+void* operator new[](size_t size, align_val_t align) { return countedAllocOrThrow(size, (size_t)align); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new(size_t size, align_val_t align, const nothrow_t&) noexcept { return countedAlloc(size, (size_t)align); }
+void* operator new[](size_t size, align_val_t align, const nothrow_t&) noexcept { return countedAlloc(size, (size_t)align); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+void operator delete(void* p, align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { countedFree(p); }
+void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { countedFree(p); }
+
+// Charges the allocations made during its lifetime to the result instead of
+// the per-row temporaries
+struct ResultGrowthScope {
+    size_t countStart = g_allocCount;
+    size_t bytesStart = g_allocBytes;
+    
+    ~ResultGrowthScope() {
+        g_resultAllocCount += g_allocCount - countStart;
+        g_resultAllocBytes += g_allocBytes - bytesStart;
+    }
+};
+#define COUNT_RESULT_GROWTH ResultGrowthScope resultGrowthScope
+#else
+#define COUNT_RESULT_GROWTH
+#endif
+
+// Rows whose temporaries share the arena before it is reset
+const int ROWS_PER_BATCH = 256;
+
+// ---------- UTF-8 word characters ----------
+
+// Lowercased ASCII letter/digit, or 0 for bytes that are not part of a word
+struct AsciiWordTable {
+    char fold[128];
+    
+    constexpr AsciiWordTable() : fold() {
+        for(int c = '0'; c <= '9'; c++) fold[c] = c;
+        for(int c = 'a'; c <= 'z'; c++) fold[c] = c;
+        for(int c = 'A'; c <= 'Z'; c++) fold[c] = c + ('a' - 'A');
+    }
+};
+static constexpr AsciiWordTable ASCII_WORD;
+
+// Emoji blocks, only used when emoji are counted as tokens. Flags are
+// regional indicator pairs and handled in emojiSequenceLength.
+static const CodeRange EMOJI_RANGES[] = {
+    {0x2600, 0x27BF}, {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF}, {0x1F900, 0x1F9FF}, {0x1FA70, 0x1FAFF},
+};
+
+template<typename Range, size_t N>
+static const Range* findRange(const Range (&ranges)[N], char32_t cp) {
+    const Range* it = upper_bound(ranges, ranges + N, cp,
+                                  [](char32_t c, const Range& r) { return c < r.lo; });
+    if(it == ranges || cp > (it - 1)->hi) return nullptr;
+    return it - 1;
+}
+
+static bool isWordCodePoint(char32_t cp) {
+    return findRange(WORD_RANGES, cp) != nullptr;
+}
+
+static bool isEmojiCodePoint(char32_t cp) {
+    return findRange(EMOJI_RANGES, cp) != nullptr;
+}
+
+static char32_t foldCase(char32_t cp) {
+    const FoldRange* r = findRange(FOLD_RANGES, cp);
+    if(!r || (r->alternating && (cp - r->lo) % 2 != 0)) return cp;
+    return cp + r->delta;
+}
+
+// Decodes one UTF-8 sequence starting at p. Returns its length, or 0 for an
+// invalid sequence (stray continuation byte, truncation, overlong form,
+// surrogate or out of range).
+static int decodeUTF8(const unsigned char* p, const unsigned char* end, char32_t& cp) {
+    int len;
+    if(*p >= 0xF0 && *p <= 0xF4) { len = 4; cp = *p & 0x07; }
+    else if(*p >= 0xE0 && *p <= 0xEF) { len = 3; cp = *p & 0x0F; }
+    else if(*p >= 0xC2 && *p <= 0xDF) { len = 2; cp = *p & 0x1F; }
+    else return 0;
+    
+    if(end - p < len) return 0;
+    for(int i = 1; i < len; i++) {
+        if((p[i] & 0xC0) != 0x80) return 0;
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    if((len == 3 && cp < 0x800) || (len == 4 && (cp < 0x10000 || cp > 0x10FFFF)) ||
+       (cp >= 0xD800 && cp <= 0xDFFF)) {
+        return 0;
+    }
+    return len;
+}
+
+static bool isSkinTone(char32_t cp) {
+    return cp >= 0x1F3FB && cp <= 0x1F3FF;
+}
+
+static bool isRegionalIndicator(char32_t cp) {
+    return cp >= 0x1F1E6 && cp <= 0x1F1FF;
+}
+
+// Byte length of the emoji sequence starting at p, or 0 if none starts there.
+// A sequence is a flag (a pair of regional indicators) or an emoji followed
+// by an optional variation selector, skin tone and tag characters, with more
+// emoji joined by ZWJ (families, professions). A skin tone on its own is not
+// an emoji.
+static int emojiSequenceLength(const unsigned char* p, const unsigned char* end) {
+    char32_t cp;
+    int len = decodeUTF8(p, end, cp);
+    if(len == 0) return 0;
+    
+    if(isRegionalIndicator(cp)) {
+        char32_t next;
+        int nextLen = p + len < end ? decodeUTF8(p + len, end, next) : 0;
+        return nextLen > 0 && isRegionalIndicator(next) ? len + nextLen : 0;
+    }
+    if(!isEmojiCodePoint(cp) || isSkinTone(cp)) return 0;
+    
+    const unsigned char* q = p + len;
+    while(q < end) {
+        int n = decodeUTF8(q, end, cp);
+        if(n == 0) break;
+        
+        if(cp == 0xFE0F || isSkinTone(cp) || (cp >= 0xE0020 && cp <= 0xE007F)) {
+            q += n;
+        } else if(cp == 0x200D) {
+            char32_t joined;
+            int joinedLen = q + n < end ? decodeUTF8(q + n, end, joined) : 0;
+            if(joinedLen == 0 || !isEmojiCodePoint(joined) || isSkinTone(joined)) break;
+            q += n + joinedLen;
+        } else {
+            break;
+        }
+    }
+    return (int)(q - p);
+}
+
+static void appendUTF8(pmr::string& out, char32_t cp) {
+    if(cp < 0x80) {
+        out += (char)cp;
+    } else if(cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if(cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+// Number of code points (not bytes) in a valid UTF-8 string
+static size_t utf8Length(string_view s) {
+    size_t count = 0;
+    for(char c : s) {
+        if(((unsigned char)c & 0xC0) != 0x80) count++;
+    }
+    return count;
+}
+
+// Words of one or two letters are mostly particles ("di", "ke", "ya") in the
+// alphabets below U+0590 (Latin, Greek, Cyrillic, Armenian). In abugidas,
+// syllabaries and CJK every character is already a syllable or a morpheme,
+// so short words in those scripts are kept.
+static bool isShortWord(string_view word) {
+    if(utf8Length(word) > 2) return false;
+    const unsigned char* p = (const unsigned char*)word.data();
+    const unsigned char* end = p + word.size();
+    while(p < end) {
+        char32_t cp;
+        int len = decodeUTF8(p, end, cp);
+        if(len == 0) return true;
+        if(cp >= 0x0590) return false;
+        p += len;
+    }
+    return true;
+}
+
+// True if none of the 8 bytes at p has its high bit set
+static bool isAsciiBlock(const unsigned char* p) {
+    uint64_t block;
+    memcpy(&block, p, sizeof(block));
+    return (block & 0x8080808080808080ULL) == 0;
+}
+
+// Upstream of the row arena: hands out heap memory and records how much the
+// arena needed beyond its own buffer during the current batch
+class ArenaOverflow : public pmr::memory_resource {
+public:
+    size_t bytes = 0;
+
+private:
+    void* do_allocate(size_t size, size_t align) override {
+        bytes += size;
+        return pmr::new_delete_resource()->allocate(size, align);
+    }
+    
+    void do_deallocate(void* p, size_t size, size_t align) override {
+        pmr::new_delete_resource()->deallocate(p, size, align);
+    }
+    
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 // Structure to hold word frequency
 struct WordFreq {
     string word;
-    int count;
+    double count;       // fractional only for weighted sample estimates
     
     bool operator<(const WordFreq& other) const {
         return count > other.count; // Sort descending
     }
 };
 
+enum Sentiment { POSITIVE, NEGATIVE, NEUTRAL, SENTIMENT_COUNT };
+
+const char* const SENTIMENT_LABELS[SENTIMENT_COUNT] = {"Positive (Suka)", "Negative (Tidak Suka)", "Neutral"};
+
+// Sample mode reads files up to this size in full instead of sampling
+const long long SAMPLE_FULL_SCAN_BYTES = 1 << 20;
+
+// Size of the informative Dirichlet prior used by the log-odds ratio
+const double LOG_ODDS_PRIOR_SIZE = 500.0;
+
+// Assigns a dense ID to every distinct word so class statistics can be kept
+// as sparse ID -> count vectors. Each word is stored once, in terms; the ids
+// keys are views into it, which stay valid because deque elements never move.
+// Copying would leave the views pointing at the original, so only moves are
+// allowed.
+struct TermVocabulary {
+    unordered_map<string_view, int> ids;
+    deque<string> terms;
+    
+    TermVocabulary() = default;
+    TermVocabulary(const TermVocabulary&) = delete;
+    TermVocabulary& operator=(const TermVocabulary&) = delete;
+    TermVocabulary(TermVocabulary&&) = default;
+    TermVocabulary& operator=(TermVocabulary&&) = default;
+    
+    int idOf(string_view term) {
+        auto it = ids.find(term);
+        if(it != ids.end()) return it->second;
+        COUNT_RESULT_GROWTH;
+        int id = (int)terms.size();
+        terms.emplace_back(term);
+        ids.emplace(terms.back(), id);
+        return id;
+    }
+};
+
+// Counts are whole numbers in a full scan; in sample mode every response is
+// added with its sampling weight, so they become fractional estimates
+struct TermCount {
+    double count = 0;      // occurrences of the term in the class
+    double documents = 0;  // responses of the class that contain the term
+};
+
+// Sparse term statistics of one sentiment class; only terms that actually
+// occur in the class have an entry
+struct ClassTermStats {
+    double documents = 0;
+    double tokens = 0;
+    unordered_map<int, TermCount> terms;
+    
+    // termIds is one response's token IDs; it is sorted in place
+    void addDocument(pmr::vector<int>& termIds, double weight = 1.0) {
+        COUNT_RESULT_GROWTH;
+        documents += weight;
+        tokens += weight * termIds.size();
+        sort(termIds.begin(), termIds.end());
+        for(size_t i = 0; i < termIds.size();) {
+            size_t j = i;
+            while(j < termIds.size() && termIds[j] == termIds[i]) j++;
+            TermCount& tc = terms[termIds[i]];
+            tc.count += weight * (j - i);
+            tc.documents += weight;
+            i = j;
+        }
+    }
+    
+    void scale(double factor) {
+        documents *= factor;
+        tokens *= factor;
+        for(auto& entry : terms) {
+            entry.second.count *= factor;
+            entry.second.documents *= factor;
+        }
+    }
+};
+
+struct DistinctiveTerm {
+    int termId;
+    string word;
+    double count;
+    double logOdds;     // z-score of the log-odds ratio vs. the other classes
+    double chiSquare;
+    double tfidf;
+};
+
 // Structure for sentiment analysis
 struct SentimentResult {
     int positive = 0;
     int negative = 0;
     int neutral = 0;
-    map<string, int> wordFrequency;
+    TermVocabulary vocabulary;
+    ClassTermStats classTerms[SENTIMENT_COUNT];
+    
+    // Set by sampleCSV. Each sampled row has weight 1 / its length in bytes,
+    // which undoes the bias of picking rows by random byte offset. The class
+    // term statistics carry the same weights, rescaled so they sum to
+    // sampledRows.
+    bool sampled = false;
+    double sampleWeights[SENTIMENT_COUNT] = {};
+    double sampleWeightSquares[SENTIMENT_COUNT] = {};
+    int sampledRows = 0;
+    long long estimatedRows = 0;
 };
 
+// Whole counts as integers, weighted sample estimates with one decimal
+static string formatCount(double count) {
+    ostringstream out;
+    if(count == floor(count)) {
+        out << (long long)count;
+    } else {
+        out << fixed << setprecision(1) << count;
+    }
+    return out.str();
+}
+
+// A sentiment share with its 95% confidence interval
+struct ProportionEstimate {
+    double share;
+    double low;
+    double high;
+};
+
+// Weighted share of one class in a sample (a ratio estimator), with a Wilson
+// score interval. The interval uses the effective sample size implied by the
+// linearized variance of the ratio, since the row weights can be correlated
+// with the class (e.g. negative answers tend to be longer).
+static ProportionEstimate estimateProportion(const SentimentResult& result, Sentiment cls) {
+    const double z = 1.96;
+    double totalWeight = 0;
+    double totalSquares = 0;
+    for(int i = 0; i < SENTIMENT_COUNT; i++) {
+        totalWeight += result.sampleWeights[i];
+        totalSquares += result.sampleWeightSquares[i];
+    }
+    int rows = result.sampledRows;
+    if(totalWeight <= 0 || rows < 2) return {0, 0, 1};
+    
+    double p = result.sampleWeights[cls] / totalWeight;
+    double ownSquares = result.sampleWeightSquares[cls];
+    double variance = (double)rows / (rows - 1)
+                    * ((1 - p) * (1 - p) * ownSquares + p * p * (totalSquares - ownSquares))
+                    / (totalWeight * totalWeight);
+    // A class with no (or only) sampled rows has zero estimated variance;
+    // fall back to the plain row count so Wilson still gives a sane interval
+    double n = variance > 0 ? p * (1 - p) / variance : rows;
+    double denominator = 1 + z * z / n;
+    double center = (p + z * z / (2 * n)) / denominator;
+    double margin = z * sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / denominator;
+    return {p, max(0.0, center - margin), min(1.0, center + margin)};
+}
+
 class SentimentAnalyzer {
 private:
-    set<string> stopWords;
+    set<string, less<>> stopWords;
     set<string> positiveWords;
     set<string> negativeWords;
+    // Count emoji as their own tokens in the word cloud
+    bool countEmoji = false;
+    // Skip the per-row debug output
+    bool quiet = false;
+    
+    // Per-row temporaries (fields, tokens, lowercased copies) live here and
+    // are released together every ROWS_PER_BATCH rows. A batch that overflows
+    // the buffer grows it by the overflow, so after a few batches the arena
+    // stops going to the heap.
+    vector<char> arenaBuffer = vector<char>(64 * 1024);
+    ArenaOverflow arenaOverflow;
+    optional<pmr::monotonic_buffer_resource> rowArena;
+    int rowsInBatch = 0;
     
     void initializeStopWords() {
         // Indonesian stop words
@@ -65,64 +507,170 @@ private:
         }
     }
     
-    string toLowerCase(string str) {
-        transform(str.begin(), str.end(), str.begin(), ::tolower);
-        return str;
+    pmr::string toLowerCase(string_view str, pmr::memory_resource* mem) {
+        pmr::string lower(str, mem);
+        for(char& c : lower) {
+            if(c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        }
+        return lower;
     }
     
-    string cleanWord(string word) {
-        string cleaned;
-        for(char c : word) {
-            if(isalnum(c)) {
-                cleaned += tolower(c);
+    // Writes the word characters of a whitespace-delimited token, case folded,
+    // to cleaned (replacing its contents).
+    // ASCII runs are copied through a lookup table 8 bytes at a time; other
+    // bytes are decoded and validated as UTF-8, and invalid sequences dropped.
+    // Emoji sequences found along the way are appended to emoji when it is
+    // given, each as one token.
+    void cleanWord(string_view word, pmr::string& cleaned, pmr::vector<string_view>* emoji = nullptr) {
+        cleaned.clear();
+        const unsigned char* p = (const unsigned char*)word.data();
+        const unsigned char* end = p + word.size();
+        
+        while(p < end) {
+            while(end - p >= 8 && isAsciiBlock(p)) {
+                for(int i = 0; i < 8; i++) {
+                    if(char f = ASCII_WORD.fold[p[i]]) cleaned += f;
+                }
+                p += 8;
+            }
+            if(p == end) break;
+            
+            if(*p < 0x80) {
+                if(char f = ASCII_WORD.fold[*p]) cleaned += f;
+                p++;
+                continue;
+            }
+            
+            char32_t cp;
+            int len = decodeUTF8(p, end, cp);
+            if(len == 0) {
+                p++;
+                continue;
+            }
+            if(isWordCodePoint(cp)) {
+                appendUTF8(cleaned, foldCase(cp));
+            } else if(emoji) {
+                if(int sequenceLen = emojiSequenceLength(p, end)) {
+                    emoji->push_back(string_view((const char*)p, sequenceLen));
+                    len = sequenceLen;
+                }
             }
+            p += len;
+        }
+    }
+    
+    void resetRowArena() {
+        rowArena.emplace(arenaBuffer.data(), arenaBuffer.size(), &arenaOverflow);
+    }
+    
+    void releaseRowArena() {
+        rowArena->release();
+        if(arenaOverflow.bytes > 0) {
+            rowArena.reset();
+            arenaBuffer.resize(arenaBuffer.size() + arenaOverflow.bytes);
+            arenaOverflow.bytes = 0;
+            resetRowArena();
         }
-        return cleaned;
+        rowsInBatch = 0;
     }
     
-    string analyzeSentimentFromChoice(const string& choice) {
-        string lower = toLowerCase(choice);
+    // Parses one CSV row and adds it to result. rowLabel and rowNumber only
+    // label the per-row debug output; weight is the row's weight in the
+    // class term statistics. Returns the row's sentiment, or SENTIMENT_COUNT
+    // if the row has no sentiment column.
+    Sentiment processRow(string_view line, const char* rowLabel, long long rowNumber, SentimentResult& result,
+                         double weight = 1.0) {
+        // Drop the previous batch's temporaries in one go
+        if(rowsInBatch == ROWS_PER_BATCH) {
+            releaseRowArena();
+        }
+        rowsInBatch++;
+        
+        pmr::vector<string_view> fields = parseCSVLine(line, &*rowArena);
+        
+        if(fields.size() < 4) return SENTIMENT_COUNT;
+        
+        string_view sentimentChoice = fields[3];
+        string_view reason = fields.size() > 4 ? fields[4] : string_view();
+        
+        // Clean up the sentiment choice (remove extra spaces)
+        sentimentChoice.remove_prefix(min(sentimentChoice.find_first_not_of(" \t\r\n"), sentimentChoice.size()));
+        sentimentChoice = sentimentChoice.substr(0, sentimentChoice.find_last_not_of(" \t\r\n") + 1);
+        
+        // Debug: Print what we're parsing
+        if(!quiet) {
+            cout << rowLabel << " " << rowNumber << " sentiment: [" << sentimentChoice << "]" << endl;
+        }
+        
+        // Analyze sentiment from choice
+        Sentiment sentiment = analyzeSentimentFromChoice(sentimentChoice, &*rowArena);
+        if(sentiment == POSITIVE) result.positive++;
+        else if(sentiment == NEGATIVE) result.negative++;
+        else result.neutral++;
+        
+        // Process reason for word cloud and the per-class term vectors
+        pmr::vector<int> termIds(&*rowArena);
+        termIds.reserve(reason.size() / 3 + 2);
+        processText(reason, result.vocabulary, termIds, &*rowArena);
+        result.classTerms[sentiment].addDocument(termIds, weight);
+        return sentiment;
+    }
+    
+    Sentiment analyzeSentimentFromChoice(string_view choice, pmr::memory_resource* mem) {
+        pmr::string lower = toLowerCase(choice, mem);
         
         // Check for negative first (more specific)
         if(lower.find("tidak") != string::npos && lower.find("suka") != string::npos) {
-            return "negative";
+            return NEGATIVE;
         }
         // Then check for positive
         else if(lower.find("iya") != string::npos || 
                 (lower.find("suka") != string::npos && lower.find("tidak") == string::npos)) {
-            return "positive";
+            return POSITIVE;
         }
-        return "neutral";
+        return NEUTRAL;
     }
 
 public:
     SentimentAnalyzer() {
         initializeStopWords();
         initializeSentimentWords();
+        resetRowArena();
     }
     
-    vector<string> parseCSVLine(const string& line) {
-        vector<string> fields;
-        string field;
+    // Splits a CSV row into fields. Unquoted fields are views into line;
+    // fields containing quotes are copied into mem without them.
+    pmr::vector<string_view> parseCSVLine(string_view line, pmr::memory_resource* mem) {
+        pmr::vector<string_view> fields(mem);
+        fields.reserve(count(line.begin(), line.end(), ',') + 1);
+        size_t start = 0;
         bool inQuotes = false;
+        bool hasQuotes = false;
         
-        for(size_t i = 0; i < line.length(); i++) {
-            char c = line[i];
-            
-            if(c == '"') {
+        for(size_t i = 0; i <= line.length(); i++) {
+            if(i == line.length() || (line[i] == ',' && !inQuotes)) {
+                string_view field = line.substr(start, i - start);
+                fields.push_back(hasQuotes ? removeQuotes(field, mem) : field);
+                start = i + 1;
+                hasQuotes = false;
+            } else if(line[i] == '"') {
                 inQuotes = !inQuotes;
-            } else if(c == ',' && !inQuotes) {
-                fields.push_back(field);
-                field.clear();
-            } else {
-                field += c;
+                hasQuotes = true;
             }
         }
-        fields.push_back(field); // Add last field
         
         return fields;
     }
     
+    string_view removeQuotes(string_view field, pmr::memory_resource* mem) {
+        char* buffer = (char*)mem->allocate(field.size(), 1);
+        size_t length = 0;
+        for(char c : field) {
+            if(c != '"') buffer[length++] = c;
+        }
+        return string_view(buffer, length);
+    }
+    
     SentimentResult analyzeCSV(const string& filename) {
         SentimentResult result;
         ifstream file(filename);
@@ -137,51 +685,194 @@ public:
         // Skip header
         getline(file, line);
         
+#ifdef COUNT_ALLOCATIONS
+        size_t allocCountStart = g_allocCount;
+        size_t allocBytesStart = g_allocBytes;
+        size_t resultCountStart = g_resultAllocCount;
+        size_t resultBytesStart = g_resultAllocBytes;
+        size_t steadyCountStart = g_allocCount - g_resultAllocCount;
+        size_t steadyBytesStart = g_allocBytes - g_resultAllocBytes;
+#endif
         while(getline(file, line)) {
             if(line.empty()) continue;
             lineCount++;
+            processRow(line, "Line", lineCount, result);
+#ifdef COUNT_ALLOCATIONS
+            // The first batch and the arena growth it triggers are warm-up;
+            // everything after that counts as steady state
+            if(lineCount == ROWS_PER_BATCH + 1) {
+                steadyCountStart = g_allocCount - g_resultAllocCount;
+                steadyBytesStart = g_allocBytes - g_resultAllocBytes;
+            }
+#endif
+        }
+#ifdef COUNT_ALLOCATIONS
+        size_t steadyAllocs = g_allocCount - g_resultAllocCount - steadyCountStart;
+        size_t steadyBytes = g_allocBytes - g_resultAllocBytes - steadyBytesStart;
+#endif
+        releaseRowArena();
+        
+        file.close();
+        cout << "\nProcessed " << lineCount << " responses." << endl;
+        
+#ifdef COUNT_ALLOCATIONS
+        // Once the arena has grown to the batch peak, the result growing
+        // (new vocabulary terms, class statistics entries) should be the
+        // only allocations left, and it is not a per-row cost
+        size_t allocs = g_allocCount - allocCountStart;
+        size_t bytes = g_allocBytes - allocBytesStart;
+        cout << "Heap allocations: " << allocs << " (" << bytes << " bytes)" << endl;
+        if(lineCount > 0) {
+            cout << "Allocations per row: " << (double)allocs / lineCount
+                 << ", bytes per row: " << (double)bytes / lineCount << endl;
+        }
+        cout << "Vocabulary/result growth: " << g_resultAllocCount - resultCountStart
+             << " allocations (" << g_resultAllocBytes - resultBytesStart << " bytes)" << endl;
+        if(lineCount > ROWS_PER_BATCH + 1) {
+            double steadyAllocsPerRow = (double)steadyAllocs / (lineCount - ROWS_PER_BATCH - 1);
+            double steadyBytesPerRow = (double)steadyBytes / (lineCount - ROWS_PER_BATCH - 1);
+            cout << "Per-row temporaries after row " << ROWS_PER_BATCH + 1 << ": " << steadyAllocsPerRow
+                 << " allocations per row, " << steadyBytesPerRow << " bytes per row" << endl;
+            if(steadyAllocsPerRow > MAX_ALLOCS_PER_ROW || steadyBytesPerRow > MAX_BYTES_PER_ROW) {
+                cerr << "Allocation budget exceeded: max " << MAX_ALLOCS_PER_ROW << " allocations and "
+                     << MAX_BYTES_PER_ROW << " bytes per row" << endl;
+                g_allocBudgetExceeded = true;
+            }
+        }
+#endif
+        return result;
+    }
+    
+    // Quick preview of a large export: instead of scanning the whole file,
+    // picks sampleRows random byte offsets and reads the row containing each
+    // one, so every row is an independent draw (with replacement) even when
+    // the file is grouped by time or class. Longer rows are more likely to be
+    // hit, so each row is weighted by 1 / its length; see estimateProportion.
+    // Files up to SAMPLE_FULL_SCAN_BYTES are simply read in full.
+    SentimentResult sampleCSV(const string& filename, int sampleRows, unsigned seed = random_device{}()) {
+        SentimentResult result;
+        ifstream file(filename, ios::binary);
+        string line;
+        int rowCount = 0;
+        
+        if(!file.is_open()) {
+            cerr << "Error: Could not open file " << filename << endl;
+            return result;
+        }
+        
+        // Skip header
+        getline(file, line);
+        streamoff dataStart = file.tellg();
+        file.seekg(0, ios::end);
+        streamoff fileSize = file.tellg();
+        
+        if(dataStart < 0 || fileSize - dataStart <= SAMPLE_FULL_SCAN_BYTES) {
+            file.close();
+            cout << "File is small enough to read in full." << endl;
+            return analyzeCSV(filename);
+        }
+        
+        result.sampled = true;
+        mt19937_64 rng(seed);
+        uniform_int_distribution<streamoff> pickOffset(dataStart, fileSize - 1);
+        vector<streamoff> offsets(sampleRows);
+        for(auto& offset : offsets) {
+            offset = pickOffset(rng);
+        }
+        // File order only to keep the seeks local; it does not affect the estimate
+        sort(offsets.begin(), offsets.end());
+        
+        double weightSum = 0;
+        for(streamoff offset : offsets) {
+            streamoff rowStart = findRowStart(file, offset, dataStart);
+            file.clear();
+            file.seekg(rowStart);
+            if(!getline(file, line)) continue;
             
-            vector<string> fields = parseCSVLine(line);
+            double weight = 1.0 / (line.size() + 1);
+            weightSum += weight;
+            if(line.empty()) continue;
             
-            // Debug: Print what we're parsing
-            if(fields.size() >= 4) {
-                string sentimentChoice = fields.size() > 3 ? fields[3] : "";
-                string reason = fields.size() > 4 ? fields[4] : "";
-                
-                // Clean up the sentiment choice (remove extra spaces)
-                sentimentChoice.erase(0, sentimentChoice.find_first_not_of(" \t\r\n"));
-                sentimentChoice.erase(sentimentChoice.find_last_not_of(" \t\r\n") + 1);
-                
-                cout << "Line " << lineCount << " sentiment: [" << sentimentChoice << "]" << endl;
-                
-                // Analyze sentiment from choice
-                string sentiment = analyzeSentimentFromChoice(sentimentChoice);
-                if(sentiment == "positive") result.positive++;
-                else if(sentiment == "negative") result.negative++;
-                else result.neutral++;
-                
-                // Process reason for word cloud
-                processText(reason, result.wordFrequency);
+            rowCount++;
+            Sentiment sentiment = processRow(line, "Sample row", rowCount, result, weight);
+            if(sentiment != SENTIMENT_COUNT) {
+                result.sampleWeights[sentiment] += weight;
+                result.sampleWeightSquares[sentiment] += weight * weight;
+                result.sampledRows++;
+            }
+        }
+        releaseRowArena();
+        
+        // Word counts and term statistics on the scale of sampledRows rows
+        // drawn uniformly, so the log-odds prior and chi-square see
+        // sample-sized counts
+        double classWeight = 0;
+        for(double w : result.sampleWeights) classWeight += w;
+        if(classWeight > 0) {
+            for(auto& stats : result.classTerms) {
+                stats.scale(result.sampledRows / classWeight);
             }
         }
         
+        // Under length-biased sampling the mean weight estimates rows per byte
+        result.estimatedRows = (long long)((fileSize - dataStart) * weightSum / sampleRows);
+        
         file.close();
-        cout << "\nProcessed " << lineCount << " responses." << endl;
+        cout << "\nSampled " << rowCount << " responses (about " << result.estimatedRows << " in the file)." << endl;
         return result;
     }
     
-    void processText(const string& text, map<string, int>& wordFreq) {
-        stringstream ss(text);
-        string word;
+    // Start of the row that contains byte offset: just after the last newline
+    // before it, or dataStart for the first row
+    streamoff findRowStart(ifstream& file, streamoff offset, streamoff dataStart) {
+        char buffer[4096];
+        streamoff end = offset;
+        
+        while(end > dataStart) {
+            streamoff start = max(dataStart, end - (streamoff)sizeof(buffer));
+            file.clear();
+            file.seekg(start);
+            file.read(buffer, end - start);
+            for(streamoff i = end - start; i > 0; i--) {
+                if(buffer[i - 1] == '\n') return start + i;
+            }
+            end = start;
+        }
+        return dataStart;
+    }
+    
+    // Appends the vocabulary ID of every counted word in text to termIds
+    void processText(string_view text, TermVocabulary& vocab, pmr::vector<int>& termIds, pmr::memory_resource* mem) {
+        const char* spaces = " \t\n\v\f\r";
+        size_t pos = text.find_first_not_of(spaces);
+        pmr::string word(mem);
+        word.reserve(text.size());
+        pmr::vector<string_view> emoji(mem);
         
-        while(ss >> word) {
-            word = cleanWord(word);
-            if(word.length() > 2 && stopWords.find(word) == stopWords.end()) {
-                wordFreq[word]++;
+        while(pos != string_view::npos) {
+            size_t end = text.find_first_of(spaces, pos);
+            string_view token = text.substr(pos, end == string_view::npos ? string_view::npos : end - pos);
+            pos = text.find_first_not_of(spaces, end);
+            
+            emoji.clear();
+            cleanWord(token, word, countEmoji ? &emoji : nullptr);
+            if(!isShortWord(word) && stopWords.find(string_view(word)) == stopWords.end()) {
+                termIds.push_back(vocab.idOf(word));
+            }
+            for(string_view e : emoji) {
+                termIds.push_back(vocab.idOf(e));
             }
         }
     }
     
+    void setCountEmoji(bool enabled) {
+        countEmoji = enabled;
+    }
+    
+    void setQuiet(bool enabled) {
+        quiet = enabled;
+    }
+    
     void displaySentimentStats(const SentimentResult& result) {
         int total = result.positive + result.negative + result.neutral;
         
@@ -196,33 +887,180 @@ public:
         cout << "================================================\n" << endl;
     }
     
-    void generateWordCloud(const map<string, int>& wordFreq, int topN = 20) {
-        vector<WordFreq> words;
+    // Ranks the terms of one class by how strongly they separate it from the
+    // other classes: log-odds ratio with an informative Dirichlet prior
+    // (Monroe et al.), reported together with a document-level chi-square and
+    // the class TF-IDF. Works only on the sparse class vectors, so the cost is
+    // proportional to the number of distinct terms in the class.
+    vector<DistinctiveTerm> findDistinctiveTerms(const SentimentResult& result, Sentiment cls, int topN = 10) {
+        double totalTokens = 0;
+        double totalDocuments = 0;
+        for(const auto& stats : result.classTerms) {
+            totalTokens += stats.tokens;
+            totalDocuments += stats.documents;
+        }
+        
+        const ClassTermStats& own = result.classTerms[cls];
+        double restTokens = totalTokens - own.tokens;
+        double restDocuments = totalDocuments - own.documents;
+        
+        auto byLogOdds = [](const DistinctiveTerm& a, const DistinctiveTerm& b) {
+            return a.logOdds > b.logOdds || (a.logOdds == b.logOdds && a.termId < b.termId);
+        };
+        priority_queue<DistinctiveTerm, vector<DistinctiveTerm>, decltype(byLogOdds)> top(byLogOdds);
+        
+        for(const auto& entry : own.terms) {
+            // Totals of this term over all classes
+            double termTokens = 0;
+            double termDocuments = 0;
+            for(const auto& stats : result.classTerms) {
+                auto it = stats.terms.find(entry.first);
+                if(it != stats.terms.end()) {
+                    termTokens += it->second.count;
+                    termDocuments += it->second.documents;
+                }
+            }
+            
+            double y1 = entry.second.count;
+            double y2 = termTokens - entry.second.count;
+            double alpha = LOG_ODDS_PRIOR_SIZE * termTokens / totalTokens;
+            double delta = log((y1 + alpha) / (own.tokens + LOG_ODDS_PRIOR_SIZE - y1 - alpha))
+                         - log((y2 + alpha) / (restTokens + LOG_ODDS_PRIOR_SIZE - y2 - alpha));
+            double z = delta / sqrt(1.0 / (y1 + alpha) + 1.0 / (y2 + alpha));
+            if(z <= 0) continue;
+            
+            // 2x2 table: class/other responses with/without the term
+            double a = entry.second.documents;
+            double b = termDocuments - entry.second.documents;
+            double c = own.documents - a;
+            double d = restDocuments - b;
+            double denominator = (a + b) * (c + d) * (a + c) * (b + d);
+            double chiSquare = denominator > 0 ? totalDocuments * (a * d - b * c) * (a * d - b * c) / denominator : 0;
+            
+            double tfidf = (y1 / own.tokens) * log(totalDocuments / termDocuments);
+            
+            // Keep only the topN best; words are looked up once at the end
+            top.push({entry.first, "", entry.second.count, z, chiSquare, tfidf});
+            if((int)top.size() > topN) top.pop();
+        }
+        
+        vector<DistinctiveTerm> terms;
+        while(!top.empty()) {
+            terms.push_back(top.top());
+            terms.back().word = result.vocabulary.terms[terms.back().termId];
+            top.pop();
+        }
+        reverse(terms.begin(), terms.end());
+        return terms;
+    }
+    
+    void displayDistinctiveTerms(const SentimentResult& result, int topN = 10) {
+        ios savedFormat(nullptr);
+        savedFormat.copyfmt(cout);
+        cout << fixed << setprecision(2);
         
-        for(const auto& pair : wordFreq) {
-            words.push_back({pair.first, pair.second});
+        cout << "\n========== DISTINCTIVE TERMS PER SENTIMENT ==========" << endl;
+        if(result.sampled) {
+            cout << "(weighted estimates from the sample)" << endl;
+        }
+        for(int cls = 0; cls < SENTIMENT_COUNT; cls++) {
+            vector<DistinctiveTerm> terms = findDistinctiveTerms(result, (Sentiment)cls, topN);
+            cout << SENTIMENT_LABELS[cls] << " (" << formatCount(result.classTerms[cls].documents) << " responses)" << endl;
+            if(terms.empty()) {
+                cout << "  (no distinctive terms)" << endl;
+                continue;
+            }
+            // The term goes last: setw pads by bytes, and wide or combining
+            // characters would shift any column after it
+            cout << "  " << setw(8) << "count" << setw(10) << "log-odds" << setw(10) << "chi2"
+                 << setw(10) << "tf-idf" << "  term" << endl;
+            for(const auto& term : terms) {
+                cout << "  " << setw(8) << formatCount(term.count) << setw(10) << term.logOdds << setw(10) << term.chiSquare
+                     << setw(10) << term.tfidf << "  " << term.word << endl;
+            }
         }
+        cout << "=====================================================\n" << endl;
         
-        sort(words.begin(), words.end());
+        cout.copyfmt(savedFormat);
+    }
+    
+    // Sentiment shares estimated from a sample, with 95% confidence intervals
+    void displaySampleStats(const SentimentResult& result) {
+        int total = result.positive + result.negative + result.neutral;
+        int counts[SENTIMENT_COUNT] = {result.positive, result.negative, result.neutral};
         
-        cout << "\n========== WORD CLOUD (Top " << min(topN, (int)words.size()) << " Words) ==========" << endl;
+        ios savedFormat(nullptr);
+        savedFormat.copyfmt(cout);
+        cout << fixed << setprecision(1);
         
-        for(int i = 0; i < min(topN, (int)words.size()); i++) {
-            string bar(words[i].count * 2, '#');
-            cout << words[i].word << " (" << words[i].count << "): " << bar << endl;
+        cout << "\n========== SAMPLED SENTIMENT (ESTIMATE) ==========" << endl;
+        cout << "Sampled Responses: " << total << " (about " << result.estimatedRows << " in the file)" << endl;
+        for(int cls = 0; cls < SENTIMENT_COUNT; cls++) {
+            ProportionEstimate estimate = estimateProportion(result, (Sentiment)cls);
+            cout << SENTIMENT_LABELS[cls] << ": " << estimate.share * 100 << "% (95% CI "
+                 << estimate.low * 100 << "% - " << estimate.high * 100 << "%), " << counts[cls] << " sampled" << endl;
         }
+        cout << "Word counts and distinctive terms below are weighted estimates: each" << endl;
+        cout << "sampled row counts as 1 / its length, scaled to the sample size." << endl;
+        cout << "==================================================\n" << endl;
         
-        cout << "================================================\n" << endl;
+        cout.copyfmt(savedFormat);
     }
     
-    void generateHTMLWordCloud(const map<string, int>& wordFreq, const string& outputFile, const SentimentResult& result) {
+    // The topN most frequent words over all classes. Totals are summed from
+    // the sparse class counts; a term is summed by the first class that
+    // contains it and skipped by the others.
+    vector<WordFreq> rankWords(const SentimentResult& result, int topN) {
+        const deque<string>& terms = result.vocabulary.terms;
+        auto better = [&terms](const pair<double, int>& a, const pair<double, int>& b) {
+            return a.first > b.first || (a.first == b.first && terms[a.second] < terms[b.second]);
+        };
+        priority_queue<pair<double, int>, vector<pair<double, int>>, decltype(better)> top(better);
+        
+        for(int cls = 0; cls < SENTIMENT_COUNT; cls++) {
+            for(const auto& entry : result.classTerms[cls].terms) {
+                bool counted = false;
+                for(int earlier = 0; earlier < cls && !counted; earlier++) {
+                    counted = result.classTerms[earlier].terms.count(entry.first) > 0;
+                }
+                if(counted) continue;
+                
+                double total = entry.second.count;
+                for(int later = cls + 1; later < SENTIMENT_COUNT; later++) {
+                    auto it = result.classTerms[later].terms.find(entry.first);
+                    if(it != result.classTerms[later].terms.end()) total += it->second.count;
+                }
+                
+                top.push({total, entry.first});
+                if((int)top.size() > topN) top.pop();
+            }
+        }
+        
         vector<WordFreq> words;
+        while(!top.empty()) {
+            words.push_back({terms[top.top().second], top.top().first});
+            top.pop();
+        }
+        reverse(words.begin(), words.end());
+        return words;
+    }
+    
+    void generateWordCloud(const SentimentResult& result, int topN = 20) {
+        vector<WordFreq> words = rankWords(result, topN);
+        
+        cout << "\n========== WORD CLOUD (Top " << words.size() << " Words"
+             << (result.sampled ? ", weighted sample estimate" : "") << ") ==========" << endl;
         
-        for(const auto& pair : wordFreq) {
-            words.push_back({pair.first, pair.second});
+        for(int i = 0; i < (int)words.size(); i++) {
+            string bar((size_t)llround(words[i].count * 2), '#');
+            cout << words[i].word << " (" << formatCount(words[i].count) << "): " << bar << endl;
         }
         
-        sort(words.begin(), words.end());
+        cout << "================================================\n" << endl;
+    }
+    
+    void generateHTMLWordCloud(const string& outputFile, const SentimentResult& result) {
+        vector<WordFreq> words = rankWords(result, 30);
         
         ofstream html(outputFile);
         
@@ -247,85 +1085,176 @@ public:
         html << ".word-cloud { display: flex; flex-wrap: wrap; justify-content: center; gap: 10px; padding: 20px; }\n";
         html << ".word { display: inline-block; padding: 5px 15px; margin: 5px; background: linear-gradient(135deg, #667eea 0%, #764ba2 100%); color: white; border-radius: 5px; font-weight: bold; transition: transform 0.2s; }\n";
         html << ".word:hover { transform: scale(1.1); }\n";
+        html << ".distinctive { display: flex; justify-content: space-around; gap: 20px; padding: 20px; }\n";
+        html << ".distinctive-column { flex: 1; background: #fafafa; border-radius: 10px; padding: 15px; }\n";
+        html << ".distinctive-column h3 { text-align: center; margin: 0 0 10px 0; }\n";
+        html << ".distinctive-column table { width: 100%; border-collapse: collapse; font-size: 14px; }\n";
+        html << ".distinctive-column th, .distinctive-column td { padding: 4px; text-align: right; border-bottom: 1px solid #eee; }\n";
+        html << ".distinctive-column th:first-child, .distinctive-column td:first-child { text-align: left; font-weight: bold; }\n";
+        if(result.sampled) {
+            html << ".sample-note { text-align: center; color: #b45309; font-style: italic; }\n";
+        }
         html << "</style>\n</head>\n<body>\n";
         html << "<div class='container'>\n";
         html << "<h1>📊 Analisis Survey Checklock</h1>\n";
         
         // Bar Chart Section
-        html << "<h2>Hasil Sentimen</h2>\n";
+        int total = result.positive + result.neutral + result.negative;
+        if(result.sampled) {
+            html << "<h2>Hasil Sentimen (Estimasi dari Sampel)</h2>\n";
+            html << "<p class='sample-note'>Estimasi dari sampel acak " << total << " baris (sekitar "
+                 << result.estimatedRows << " baris di file), dengan selang kepercayaan 95%.</p>\n";
+        } else {
+            html << "<h2>Hasil Sentimen</h2>\n";
+        }
         html << "<div class='chart-container'>\n";
         html << "<div class='bar-chart'>\n";
         
-        int total = result.positive + result.neutral + result.negative;
-        int maxCount = max({result.positive, result.neutral, result.negative});
-        
-        // Positive Bar
-        int positiveHeight = maxCount > 0 ? (result.positive * 250 / maxCount) : 0;
-        html << "<div class='bar-wrapper'>\n";
-        html << "<div class='bar positive-bar' style='height: " << positiveHeight << "px;'>" << result.positive << "</div>\n";
-        html << "<div class='bar-label'>✅ Suka</div>\n";
-        html << "<div class='bar-count'>" << result.positive << " menjawab iya suka!</div>\n";
-        html << "</div>\n";
-        
-        // Neutral Bar
-        int neutralHeight = maxCount > 0 ? (result.neutral * 250 / maxCount) : 0;
-        html << "<div class='bar-wrapper'>\n";
-        html << "<div class='bar neutral-bar' style='height: " << neutralHeight << "px;'>" << result.neutral << "</div>\n";
-        html << "<div class='bar-label'>😐 Netral</div>\n";
-        html << "<div class='bar-count'>" << result.neutral << " menjawab netral!</div>\n";
-        html << "</div>\n";
-        
-        // Negative Bar
-        int negativeHeight = maxCount > 0 ? (result.negative * 250 / maxCount) : 0;
-        html << "<div class='bar-wrapper'>\n";
-        html << "<div class='bar negative-bar' style='height: " << negativeHeight << "px;'>" << result.negative << "</div>\n";
-        html << "<div class='bar-label'>❌ Tidak Suka</div>\n";
-        html << "<div class='bar-count'>" << result.negative << " menjawab tidak suka!</div>\n";
-        html << "</div>\n";
+        if(result.sampled) {
+            // Sample mode: estimated shares and their intervals instead of raw counts
+            const Sentiment order[] = {POSITIVE, NEUTRAL, NEGATIVE};
+            const char* barClasses[SENTIMENT_COUNT] = {"positive-bar", "negative-bar", "neutral-bar"};
+            const char* barLabels[SENTIMENT_COUNT] = {"✅ Suka", "❌ Tidak Suka", "😐 Netral"};
+            double maxShare = 0;
+            for(Sentiment cls : order) {
+                maxShare = max(maxShare, estimateProportion(result, cls).share);
+            }
+            
+            html << fixed << setprecision(1);
+            for(Sentiment cls : order) {
+                ProportionEstimate estimate = estimateProportion(result, cls);
+                int height = maxShare > 0 ? (int)(estimate.share * 250 / maxShare) : 0;
+                html << "<div class='bar-wrapper'>\n";
+                html << "<div class='bar " << barClasses[cls] << "' style='height: " << height << "px;'>" << estimate.share * 100 << "%</div>\n";
+                html << "<div class='bar-label'>" << barLabels[cls] << "</div>\n";
+                html << "<div class='bar-count'>95% CI " << estimate.low * 100 << "% - " << estimate.high * 100 << "%</div>\n";
+                html << "</div>\n";
+            }
+        } else {
+            int maxCount = max({result.positive, result.neutral, result.negative});
+            
+            // Positive Bar
+            int positiveHeight = maxCount > 0 ? (result.positive * 250 / maxCount) : 0;
+            html << "<div class='bar-wrapper'>\n";
+            html << "<div class='bar positive-bar' style='height: " << positiveHeight << "px;'>" << result.positive << "</div>\n";
+            html << "<div class='bar-label'>✅ Suka</div>\n";
+            html << "<div class='bar-count'>" << result.positive << " menjawab iya suka!</div>\n";
+            html << "</div>\n";
+            
+            // Neutral Bar
+            int neutralHeight = maxCount > 0 ? (result.neutral * 250 / maxCount) : 0;
+            html << "<div class='bar-wrapper'>\n";
+            html << "<div class='bar neutral-bar' style='height: " << neutralHeight << "px;'>" << result.neutral << "</div>\n";
+            html << "<div class='bar-label'>😐 Netral</div>\n";
+            html << "<div class='bar-count'>" << result.neutral << " menjawab netral!</div>\n";
+            html << "</div>\n";
+            
+            // Negative Bar
+            int negativeHeight = maxCount > 0 ? (result.negative * 250 / maxCount) : 0;
+            html << "<div class='bar-wrapper'>\n";
+            html << "<div class='bar negative-bar' style='height: " << negativeHeight << "px;'>" << result.negative << "</div>\n";
+            html << "<div class='bar-label'>❌ Tidak Suka</div>\n";
+            html << "<div class='bar-count'>" << result.negative << " menjawab tidak suka!</div>\n";
+            html << "</div>\n";
+        }
         
         html << "</div>\n";
         html << "</div>\n";
         
         // Word Cloud Section
-        html << "<h2>Word Cloud - Kata yang Sering Muncul</h2>\n";
+        html << "<h2>Word Cloud - Kata yang Sering Muncul" << (result.sampled ? " (Estimasi Sampel Berbobot)" : "") << "</h2>\n";
+        if(result.sampled) {
+            html << "<p class='sample-note'>Jumlah kata adalah estimasi berbobot: tiap baris sampel dihitung 1 / panjangnya, "
+                 << "diskalakan ke ukuran sampel.</p>\n";
+        }
         html << "<div class='word-cloud'>\n";
         
         for(int i = 0; i < min(30, (int)words.size()); i++) {
-            int fontSize = 12 + (words[i].count * 3);
-            fontSize = min(fontSize, 48);
+            int fontSize = (int)min(12 + words[i].count * 3, 48.0);
             html << "<span class='word' style='font-size: " << fontSize << "px;'>" 
-                 << words[i].word << " (" << words[i].count << ")</span>\n";
+                 << words[i].word << " (" << formatCount(words[i].count) << ")</span>\n";
+        }
+        
+        html << "</div>\n";
+        
+        // Distinctive Terms Section
+        const char* columnColors[SENTIMENT_COUNT] = {"#10b981", "#ef4444", "#f59e0b"};
+        html << "<h2>Kata Pembeda per Sentimen" << (result.sampled ? " (Estimasi Sampel Berbobot)" : "") << "</h2>\n";
+        html << "<div class='distinctive'>\n";
+        html << fixed << setprecision(2);
+        for(int cls = 0; cls < SENTIMENT_COUNT; cls++) {
+            html << "<div class='distinctive-column'>\n";
+            html << "<h3 style='color: " << columnColors[cls] << ";'>" << SENTIMENT_LABELS[cls] << "</h3>\n";
+            html << "<table>\n<tr><th>Kata</th><th>Jumlah</th><th>Log-odds</th><th>Chi&sup2;</th><th>TF-IDF</th></tr>\n";
+            for(const auto& term : findDistinctiveTerms(result, (Sentiment)cls, 10)) {
+                html << "<tr><td>" << term.word << "</td><td>" << formatCount(term.count) << "</td><td>" << term.logOdds
+                     << "</td><td>" << term.chiSquare << "</td><td>" << term.tfidf << "</td></tr>\n";
+            }
+            html << "</table>\n</div>\n";
         }
+        html << "</div>\n";
         
-        html << "</div>\n</div>\n</body>\n</html>";
+        html << "</div>\n</body>\n</html>";
         html.close();
         
         cout << "HTML word cloud generated: " << outputFile << endl;
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     cout << "=== Sentiment Analysis & Word Cloud Generator ===" << endl;
     cout << "Converting Excel/CSV data to word cloud...\n" << endl;
     
     SentimentAnalyzer analyzer;
     
+    // --emoji: count emoji as words in the word cloud
+    // --sample[=N]: estimate from N rows (default 1000) picked at random offsets
+    // --seed=N: fixed seed for --sample
+    // --quiet: no per-row output
+    int sampleRows = 0;
+    unsigned seed = random_device{}();
+    for(int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if(arg == "--emoji") {
+            analyzer.setCountEmoji(true);
+        } else if(arg == "--quiet") {
+            analyzer.setQuiet(true);
+        } else if(arg == "--sample") {
+            sampleRows = 1000;
+        } else if(arg.rfind("--sample=", 0) == 0) {
+            sampleRows = max(1, atoi(arg.c_str() + 9));
+        } else if(arg.rfind("--seed=", 0) == 0) {
+            seed = (unsigned)strtoul(arg.c_str() + 7, nullptr, 10);
+        }
+    }
+    
     // Analyze the CSV file
     string filename = "survey_data.csv";
     cout << "Reading file: " << filename << endl;
     
-    SentimentResult result = analyzer.analyzeCSV(filename);
+    SentimentResult result = sampleRows > 0 ? analyzer.sampleCSV(filename, sampleRows, seed)
+                                            : analyzer.analyzeCSV(filename);
     
     // Display sentiment statistics
-    analyzer.displaySentimentStats(result);
+    if(result.sampled) {
+        analyzer.displaySampleStats(result);
+    } else {
+        analyzer.displaySentimentStats(result);
+    }
     
     // Generate text-based word cloud
-    analyzer.generateWordCloud(result.wordFrequency, 20);
+    analyzer.generateWordCloud(result, 20);
+    
+    // Show which words separate the sentiment classes
+    analyzer.displayDistinctiveTerms(result, 10);
     
     // Generate HTML word cloud
-    analyzer.generateHTMLWordCloud(result.wordFrequency, "wordcloud.html", result);
+    analyzer.generateHTMLWordCloud("wordcloud.html", result);
     
     cout << "\nAnalysis complete! Open 'wordcloud.html' in your browser to see the visual word cloud." << endl;
     
+#ifdef COUNT_ALLOCATIONS
+    if(g_allocBudgetExceeded) return 1;
+#endif
     return 0;
 }
\ No newline at end of file
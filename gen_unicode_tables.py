@@ -0,0 +1,116 @@
+# Generates unicode_tables.h, the word character and case folding tables
+# shared by analysis_sentiment.cpp and poster_maker_AS.cpp, from the Unicode
+# Character Database:
+#
+#   python gen_unicode_tables.py UnicodeData.txt CaseFolding.txt unicode_tables.h
+#
+# Word characters are the general categories L* (letters) and M* (combining
+# marks, so accents and Indic/Thai vowel signs stay attached). Case folding
+# uses the simple mappings (status C and S) plus the Turkic U+0130 -> i, the
+# only way to fold capital dotted I to a single code point; the Turkic
+# I -> dotless i is left out so plain ASCII keeps folding to i.
+# ASCII is handled separately by the programs and is not in the tables.
+
+import sys
+
+
+def read_word_ranges(path):
+    points = []
+    first = None
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            fields = line.split(";")
+            if len(fields) < 3:
+                continue
+            cp = int(fields[0], 16)
+            name, category = fields[1], fields[2]
+            if name.endswith(", First>"):
+                first = cp
+                continue
+            lo = first if name.endswith(", Last>") else cp
+            first = None
+            if category[0] in "LM":
+                points.extend(range(max(lo, 0x80), cp + 1))
+    ranges = []
+    for cp in sorted(points):
+        if ranges and ranges[-1][1] == cp - 1:
+            ranges[-1][1] = cp
+        else:
+            ranges.append([cp, cp])
+    return ranges
+
+
+def read_folds(path):
+    folds = {}
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.split("#")[0].strip()
+            if not line:
+                continue
+            code, status, mapping = [x.strip() for x in line.split(";")[:3]]
+            cp = int(code, 16)
+            if cp < 0x80:
+                continue
+            if status in ("C", "S") or (status == "T" and cp == 0x130):
+                folds[cp] = int(mapping, 16)
+    return folds
+
+
+# Packs the folds into [lo, hi] runs sharing one delta, either contiguous or
+# alternating (only every other code point from lo folds, the gaps are the
+# lowercase letters).
+def pack_folds(folds):
+    cps = sorted(folds)
+    runs = []
+    i = 0
+    while i < len(cps):
+        lo = cps[i]
+        delta = folds[lo] - lo
+        j = i
+        alternating = False
+        if i + 1 < len(cps) and folds[cps[i + 1]] - cps[i + 1] == delta:
+            step = cps[i + 1] - lo
+            if step in (1, 2):
+                alternating = step == 2
+                while (j + 1 < len(cps) and cps[j + 1] - cps[j] == step
+                       and folds[cps[j + 1]] - cps[j + 1] == delta):
+                    j += 1
+        runs.append((lo, cps[j], delta, alternating))
+        i = j + 1
+    return runs
+
+
+def write_rows(out, items, per_line):
+    for i in range(0, len(items), per_line):
+        out.write("    " + " ".join(items[i:i + per_line]) + "\n")
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit("usage: gen_unicode_tables.py UnicodeData.txt CaseFolding.txt unicode_tables.h")
+    word_ranges = read_word_ranges(sys.argv[1])
+    fold_runs = pack_folds(read_folds(sys.argv[2]))
+
+    with open(sys.argv[3], "w", encoding="utf-8", newline="\r\n") as out:
+        out.write("// Generated by gen_unicode_tables.py from UnicodeData.txt and\n")
+        out.write("// CaseFolding.txt. Do not edit by hand.\n")
+        out.write("#ifndef UNICODE_TABLES_H\n#define UNICODE_TABLES_H\n\n")
+        out.write("struct CodeRange {\n    char32_t lo;\n    char32_t hi;\n};\n\n")
+        out.write("// Simple case folding: code points in [lo, hi] fold to cp + delta. With\n")
+        out.write("// alternating set only every other code point starting at lo folds (the\n")
+        out.write("// usual Upper/lower pairs of Latin Extended and Cyrillic).\n")
+        out.write("struct FoldRange {\n    char32_t lo;\n    char32_t hi;\n    int delta;\n    bool alternating;\n};\n\n")
+        out.write("// Non-ASCII code points of general category L* or M*. Sorted by lo.\n")
+        out.write("static const CodeRange WORD_RANGES[] = {\n")
+        write_rows(out, ["{0x%04X, 0x%04X}," % (lo, hi) for lo, hi in word_ranges], 4)
+        out.write("};\n\n")
+        out.write("// Non-ASCII simple case folds (CaseFolding.txt status C and S, plus the\n")
+        out.write("// Turkic U+0130 -> i). Sorted by lo.\n")
+        out.write("static const FoldRange FOLD_RANGES[] = {\n")
+        write_rows(out, ["{0x%04X, 0x%04X, %d, %s}," % (lo, hi, delta, "true" if alt else "false")
+                         for lo, hi, delta, alt in fold_runs], 3)
+        out.write("};\n\n#endif\n")
+
+
+if __name__ == "__main__":
+    main()
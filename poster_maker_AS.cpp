@@ -7,9 +7,256 @@
 #include <algorithm>
 #include <cctype>
 #include <set>
+#include <string_view>
+#include <memory_resource>
+#include <optional>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+
+#include "unicode_tables.h"
 
 using namespace std;
 
+#ifdef COUNT_ALLOCATIONS
+#include <new>
+
+#ifndef MAX_ALLOCS_PER_ROW
+#define MAX_ALLOCS_PER_ROW 0.1
+#endif
+#ifndef MAX_BYTES_PER_ROW
+#define MAX_BYTES_PER_ROW 16.0
+#endif
+
+#if defined(_MSC_VER)
+#define ALLOC_NOINLINE __declspec(noinline)
+#else
+#define ALLOC_NOINLINE __attribute__((noinline))
+#endif
+
+static size_t g_allocCount = 0;
+static size_t g_allocBytes = 0;
+static size_t g_resultAllocCount = 0;
+static size_t g_resultAllocBytes = 0;
+static bool g_allocBudgetExceeded = false;
+
+ALLOC_NOINLINE static void* countedAlloc(size_t size, size_t align) noexcept {
+    g_allocCount++;
+    g_allocBytes += size;
+    align = max(align, alignof(max_align_t));
+    char* raw = (char*)malloc(size + align + sizeof(void*));
+    if(!raw) return nullptr;
+    uintptr_t aligned = ((uintptr_t)(raw + sizeof(void*)) + align - 1) & ~(uintptr_t)(align - 1);
+    ((void**)aligned)[-1] = raw;
+    return (void*)aligned;
+}
+
+ALLOC_NOINLINE static void countedFree(void* p) noexcept {
+    if(p) free(((void**)p)[-1]);
+}
+
+ALLOC_NOINLINE static void* countedAllocOrThrow(size_t size, size_t align) {
+    if(void* p = countedAlloc(size, align)) return p;
+    throw bad_alloc();
+}
+
+void* operator new(size_t size) { return countedAllocOrThrow(size, 0); }
+void* operator new[](size_t size) { return countedAllocOrThrow(size, 0); }
+void* operator new(size_t size, align_val_t align) { return countedAllocOrThrow(size, (size_t)align); }
+void* operator new[](size_t size, align_val_t align) { return countedAllocOrThrow(size, (size_t)align); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new(size_t size, align_val_t align, const nothrow_t&) noexcept { return countedAlloc(size, (size_t)align); }
+void* operator new[](size_t size, align_val_t align, const nothrow_t&) noexcept { return countedAlloc(size, (size_t)align); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+void operator delete(void* p, align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { countedFree(p); }
+void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { countedFree(p); }
+
+struct ResultGrowthScope {
+    size_t countStart = g_allocCount;
+    size_t bytesStart = g_allocBytes;
+    
+    ~ResultGrowthScope() {
+        g_resultAllocCount += g_allocCount - countStart;
+        g_resultAllocBytes += g_allocBytes - bytesStart;
+    }
+};
+#define COUNT_RESULT_GROWTH ResultGrowthScope resultGrowthScope
+#else
+#define COUNT_RESULT_GROWTH
+#endif
+
+const int ROWS_PER_BATCH = 256;
+
+struct AsciiWordTable {
+    char fold[128];
+    
+    constexpr AsciiWordTable() : fold() {
+        for(int c = '0'; c <= '9'; c++) fold[c] = c;
+        for(int c = 'a'; c <= 'z'; c++) fold[c] = c;
+        for(int c = 'A'; c <= 'Z'; c++) fold[c] = c + ('a' - 'A');
+    }
+};
+static constexpr AsciiWordTable ASCII_WORD;
+
+static const CodeRange EMOJI_RANGES[] = {
+    {0x2600, 0x27BF}, {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF}, {0x1F900, 0x1F9FF}, {0x1FA70, 0x1FAFF},
+};
+
+template<typename Range, size_t N>
+static const Range* findRange(const Range (&ranges)[N], char32_t cp) {
+    const Range* it = upper_bound(ranges, ranges + N, cp,
+                                  [](char32_t c, const Range& r) { return c < r.lo; });
+    if(it == ranges || cp > (it - 1)->hi) return nullptr;
+    return it - 1;
+}
+
+static bool isWordCodePoint(char32_t cp) {
+    return findRange(WORD_RANGES, cp) != nullptr;
+}
+
+static bool isEmojiCodePoint(char32_t cp) {
+    return findRange(EMOJI_RANGES, cp) != nullptr;
+}
+
+static char32_t foldCase(char32_t cp) {
+    const FoldRange* r = findRange(FOLD_RANGES, cp);
+    if(!r || (r->alternating && (cp - r->lo) % 2 != 0)) return cp;
+    return cp + r->delta;
+}
+
+static int decodeUTF8(const unsigned char* p, const unsigned char* end, char32_t& cp) {
+    int len;
+    if(*p >= 0xF0 && *p <= 0xF4) { len = 4; cp = *p & 0x07; }
+    else if(*p >= 0xE0 && *p <= 0xEF) { len = 3; cp = *p & 0x0F; }
+    else if(*p >= 0xC2 && *p <= 0xDF) { len = 2; cp = *p & 0x1F; }
+    else return 0;
+    
+    if(end - p < len) return 0;
+    for(int i = 1; i < len; i++) {
+        if((p[i] & 0xC0) != 0x80) return 0;
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    if((len == 3 && cp < 0x800) || (len == 4 && (cp < 0x10000 || cp > 0x10FFFF)) ||
+       (cp >= 0xD800 && cp <= 0xDFFF)) {
+        return 0;
+    }
+    return len;
+}
+
+static bool isSkinTone(char32_t cp) {
+    return cp >= 0x1F3FB && cp <= 0x1F3FF;
+}
+
+static bool isRegionalIndicator(char32_t cp) {
+    return cp >= 0x1F1E6 && cp <= 0x1F1FF;
+}
+
+static int emojiSequenceLength(const unsigned char* p, const unsigned char* end) {
+    char32_t cp;
+    int len = decodeUTF8(p, end, cp);
+    if(len == 0) return 0;
+    
+    if(isRegionalIndicator(cp)) {
+        char32_t next;
+        int nextLen = p + len < end ? decodeUTF8(p + len, end, next) : 0;
+        return nextLen > 0 && isRegionalIndicator(next) ? len + nextLen : 0;
+    }
+    if(!isEmojiCodePoint(cp) || isSkinTone(cp)) return 0;
+    
+    const unsigned char* q = p + len;
+    while(q < end) {
+        int n = decodeUTF8(q, end, cp);
+        if(n == 0) break;
+        
+        if(cp == 0xFE0F || isSkinTone(cp) || (cp >= 0xE0020 && cp <= 0xE007F)) {
+            q += n;
+        } else if(cp == 0x200D) {
+            char32_t joined;
+            int joinedLen = q + n < end ? decodeUTF8(q + n, end, joined) : 0;
+            if(joinedLen == 0 || !isEmojiCodePoint(joined) || isSkinTone(joined)) break;
+            q += n + joinedLen;
+        } else {
+            break;
+        }
+    }
+    return (int)(q - p);
+}
+
+static void appendUTF8(pmr::string& out, char32_t cp) {
+    if(cp < 0x80) {
+        out += (char)cp;
+    } else if(cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if(cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+static size_t utf8Length(string_view s) {
+    size_t count = 0;
+    for(char c : s) {
+        if(((unsigned char)c & 0xC0) != 0x80) count++;
+    }
+    return count;
+}
+
+static bool isShortWord(string_view word) {
+    if(utf8Length(word) > 2) return false;
+    const unsigned char* p = (const unsigned char*)word.data();
+    const unsigned char* end = p + word.size();
+    while(p < end) {
+        char32_t cp;
+        int len = decodeUTF8(p, end, cp);
+        if(len == 0) return true;
+        if(cp >= 0x0590) return false;
+        p += len;
+    }
+    return true;
+}
+
+static bool isAsciiBlock(const unsigned char* p) {
+    uint64_t block;
+    memcpy(&block, p, sizeof(block));
+    return (block & 0x8080808080808080ULL) == 0;
+}
+
+class ArenaOverflow : public pmr::memory_resource {
+public:
+    size_t bytes = 0;
+
+private:
+    void* do_allocate(size_t size, size_t align) override {
+        bytes += size;
+        return pmr::new_delete_resource()->allocate(size, align);
+    }
+    
+    void do_deallocate(void* p, size_t size, size_t align) override {
+        pmr::new_delete_resource()->deallocate(p, size, align);
+    }
+    
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 struct WordFreq {
     string word;
     int count;
@@ -19,18 +266,29 @@ struct WordFreq {
     }
 };
 
+typedef map<string, int, less<>> WordCountMap;
+
+enum Sentiment { POSITIVE, NEGATIVE, NEUTRAL };
+
 struct SentimentResult {
     int positive = 0;
     int negative = 0;
     int neutral = 0;
-    map<string, int> wordFrequency;
+    WordCountMap wordFrequency;
 };
 
 class SentimentAnalyzer {
 private:
-    set<string> stopWords;
+    set<string, less<>> stopWords;
     set<string> positiveWords;
     set<string> negativeWords;
+    bool countEmoji = false;
+    bool quiet = false;
+    
+    vector<char> arenaBuffer = vector<char>(64 * 1024);
+    ArenaOverflow arenaOverflow;
+    optional<pmr::monotonic_buffer_resource> rowArena;
+    int rowsInBatch = 0;
     
     void initializeStopWords() {
         string stops[] = {"yang", "di", "ke", "dari", "ini", "itu", "untuk", 
@@ -60,60 +318,116 @@ private:
         }
     }
     
-    string toLowerCase(string str) {
-        transform(str.begin(), str.end(), str.begin(), ::tolower);
-        return str;
+    pmr::string toLowerCase(string_view str, pmr::memory_resource* mem) {
+        pmr::string lower(str, mem);
+        for(char& c : lower) {
+            if(c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        }
+        return lower;
     }
     
-    string cleanWord(string word) {
-        string cleaned;
-        for(char c : word) {
-            if(isalnum(c)) {
-                cleaned += tolower(c);
+    void cleanWord(string_view word, pmr::string& cleaned, pmr::vector<string_view>* emoji = nullptr) {
+        cleaned.clear();
+        const unsigned char* p = (const unsigned char*)word.data();
+        const unsigned char* end = p + word.size();
+        
+        while(p < end) {
+            while(end - p >= 8 && isAsciiBlock(p)) {
+                for(int i = 0; i < 8; i++) {
+                    if(char f = ASCII_WORD.fold[p[i]]) cleaned += f;
+                }
+                p += 8;
             }
+            if(p == end) break;
+            
+            if(*p < 0x80) {
+                if(char f = ASCII_WORD.fold[*p]) cleaned += f;
+                p++;
+                continue;
+            }
+            
+            char32_t cp;
+            int len = decodeUTF8(p, end, cp);
+            if(len == 0) {
+                p++;
+                continue;
+            }
+            if(isWordCodePoint(cp)) {
+                appendUTF8(cleaned, foldCase(cp));
+            } else if(emoji) {
+                if(int sequenceLen = emojiSequenceLength(p, end)) {
+                    emoji->push_back(string_view((const char*)p, sequenceLen));
+                    len = sequenceLen;
+                }
+            }
+            p += len;
         }
-        return cleaned;
     }
     
-    string analyzeSentimentFromChoice(const string& choice) {
-        string lower = toLowerCase(choice);
+    Sentiment analyzeSentimentFromChoice(string_view choice, pmr::memory_resource* mem) {
+        pmr::string lower = toLowerCase(choice, mem);
         
         if(lower.find("tidak") != string::npos && lower.find("suka") != string::npos) {
-            return "negative";
+            return NEGATIVE;
         }
         else if(lower.find("iya") != string::npos || 
                 (lower.find("suka") != string::npos && lower.find("tidak") == string::npos)) {
-            return "positive";
+            return POSITIVE;
         }
-        return "neutral";
+        return NEUTRAL;
+    }
+    
+    void resetRowArena() {
+        rowArena.emplace(arenaBuffer.data(), arenaBuffer.size(), &arenaOverflow);
     }
     
-    vector<string> parseCSVLine(const string& line) {
-        vector<string> fields;
-        string field;
+    void releaseRowArena() {
+        rowArena->release();
+        if(arenaOverflow.bytes > 0) {
+            rowArena.reset();
+            arenaBuffer.resize(arenaBuffer.size() + arenaOverflow.bytes);
+            arenaOverflow.bytes = 0;
+            resetRowArena();
+        }
+        rowsInBatch = 0;
+    }
+    
+    pmr::vector<string_view> parseCSVLine(string_view line, pmr::memory_resource* mem) {
+        pmr::vector<string_view> fields(mem);
+        fields.reserve(count(line.begin(), line.end(), ',') + 1);
+        size_t start = 0;
         bool inQuotes = false;
-        
-        for(size_t i = 0; i < line.length(); i++) {
-            char c = line[i];
-            
-            if(c == '"') {
+        bool hasQuotes = false;
+        
+        for(size_t i = 0; i <= line.length(); i++) {
+            if(i == line.length() || (line[i] == ',' && !inQuotes)) {
+                string_view field = line.substr(start, i - start);
+                fields.push_back(hasQuotes ? removeQuotes(field, mem) : field);
+                start = i + 1;
+                hasQuotes = false;
+            } else if(line[i] == '"') {
                 inQuotes = !inQuotes;
-            } else if(c == ',' && !inQuotes) {
-                fields.push_back(field);
-                field.clear();
-            } else {
-                field += c;
+                hasQuotes = true;
             }
         }
-        fields.push_back(field);
         
         return fields;
     }
+    
+    string_view removeQuotes(string_view field, pmr::memory_resource* mem) {
+        char* buffer = (char*)mem->allocate(field.size(), 1);
+        size_t length = 0;
+        for(char c : field) {
+            if(c != '"') buffer[length++] = c;
+        }
+        return string_view(buffer, length);
+    }
 
 public:
     SentimentAnalyzer() {
         initializeStopWords();
         initializeSentimentWords();
+        resetRowArena();
     }
     
     SentimentResult analyzeCSV(const string& filename) {
@@ -129,47 +443,125 @@ public:
         
         getline(file, line);
         
+#ifdef COUNT_ALLOCATIONS
+        size_t allocCountStart = g_allocCount;
+        size_t allocBytesStart = g_allocBytes;
+        size_t resultCountStart = g_resultAllocCount;
+        size_t resultBytesStart = g_resultAllocBytes;
+        size_t steadyCountStart = g_allocCount - g_resultAllocCount;
+        size_t steadyBytesStart = g_allocBytes - g_resultAllocBytes;
+#endif
         while(getline(file, line)) {
             if(line.empty()) continue;
             lineCount++;
             
-            vector<string> fields = parseCSVLine(line);
+            if(rowsInBatch == ROWS_PER_BATCH) {
+                releaseRowArena();
+            }
+            rowsInBatch++;
+            
+            pmr::vector<string_view> fields = parseCSVLine(line, &*rowArena);
             
             if(fields.size() >= 4) {
-                string sentimentChoice = fields.size() > 3 ? fields[3] : "";
-                string reason = fields.size() > 4 ? fields[4] : "";
+                string_view sentimentChoice = fields[3];
+                string_view reason = fields.size() > 4 ? fields[4] : string_view();
                 
-                sentimentChoice.erase(0, sentimentChoice.find_first_not_of(" \t\r\n"));
-                sentimentChoice.erase(sentimentChoice.find_last_not_of(" \t\r\n") + 1);
+                sentimentChoice.remove_prefix(min(sentimentChoice.find_first_not_of(" \t\r\n"), sentimentChoice.size()));
+                sentimentChoice = sentimentChoice.substr(0, sentimentChoice.find_last_not_of(" \t\r\n") + 1);
                 
-                cout << "Line " << lineCount << " sentiment: [" << sentimentChoice << "]" << endl;
+                if(!quiet) {
+                    cout << "Line " << lineCount << " sentiment: [" << sentimentChoice << "]" << endl;
+                }
                 
-                string sentiment = analyzeSentimentFromChoice(sentimentChoice);
-                if(sentiment == "positive") result.positive++;
-                else if(sentiment == "negative") result.negative++;
+                Sentiment sentiment = analyzeSentimentFromChoice(sentimentChoice, &*rowArena);
+                if(sentiment == POSITIVE) result.positive++;
+                else if(sentiment == NEGATIVE) result.negative++;
                 else result.neutral++;
                 
-                processText(reason, result.wordFrequency);
+                processText(reason, result.wordFrequency, &*rowArena);
+            }
+#ifdef COUNT_ALLOCATIONS
+            if(lineCount == ROWS_PER_BATCH + 1) {
+                steadyCountStart = g_allocCount - g_resultAllocCount;
+                steadyBytesStart = g_allocBytes - g_resultAllocBytes;
             }
+#endif
         }
+#ifdef COUNT_ALLOCATIONS
+        size_t steadyAllocs = g_allocCount - g_resultAllocCount - steadyCountStart;
+        size_t steadyBytes = g_allocBytes - g_resultAllocBytes - steadyBytesStart;
+#endif
+        releaseRowArena();
         
         file.close();
         cout << "\nProcessed " << lineCount << " responses." << endl;
+        
+#ifdef COUNT_ALLOCATIONS
+        size_t allocs = g_allocCount - allocCountStart;
+        size_t bytes = g_allocBytes - allocBytesStart;
+        cout << "Heap allocations: " << allocs << " (" << bytes << " bytes)" << endl;
+        if(lineCount > 0) {
+            cout << "Allocations per row: " << (double)allocs / lineCount
+                 << ", bytes per row: " << (double)bytes / lineCount << endl;
+        }
+        cout << "Vocabulary/result growth: " << g_resultAllocCount - resultCountStart
+             << " allocations (" << g_resultAllocBytes - resultBytesStart << " bytes)" << endl;
+        if(lineCount > ROWS_PER_BATCH + 1) {
+            double steadyAllocsPerRow = (double)steadyAllocs / (lineCount - ROWS_PER_BATCH - 1);
+            double steadyBytesPerRow = (double)steadyBytes / (lineCount - ROWS_PER_BATCH - 1);
+            cout << "Per-row temporaries after row " << ROWS_PER_BATCH + 1 << ": " << steadyAllocsPerRow
+                 << " allocations per row, " << steadyBytesPerRow << " bytes per row" << endl;
+            if(steadyAllocsPerRow > MAX_ALLOCS_PER_ROW || steadyBytesPerRow > MAX_BYTES_PER_ROW) {
+                cerr << "Allocation budget exceeded: max " << MAX_ALLOCS_PER_ROW << " allocations and "
+                     << MAX_BYTES_PER_ROW << " bytes per row" << endl;
+                g_allocBudgetExceeded = true;
+            }
+        }
+#endif
         return result;
     }
     
-    void processText(const string& text, map<string, int>& wordFreq) {
-        stringstream ss(text);
-        string word;
-        
-        while(ss >> word) {
-            word = cleanWord(word);
-            if(word.length() > 2 && stopWords.find(word) == stopWords.end()) {
-                wordFreq[word]++;
+    void processText(string_view text, WordCountMap& wordFreq, pmr::memory_resource* mem = pmr::get_default_resource()) {
+        const char* spaces = " \t\n\v\f\r";
+        size_t pos = text.find_first_not_of(spaces);
+        pmr::string word(mem);
+        word.reserve(text.size());
+        pmr::vector<string_view> emoji(mem);
+        
+        while(pos != string_view::npos) {
+            size_t end = text.find_first_of(spaces, pos);
+            string_view token = text.substr(pos, end == string_view::npos ? string_view::npos : end - pos);
+            pos = text.find_first_not_of(spaces, end);
+            
+            emoji.clear();
+            cleanWord(token, word, countEmoji ? &emoji : nullptr);
+            if(!isShortWord(word) && stopWords.find(string_view(word)) == stopWords.end()) {
+                countWord(word, wordFreq);
             }
+            for(string_view e : emoji) {
+                countWord(e, wordFreq);
+            }
+        }
+    }
+    
+    void countWord(string_view word, WordCountMap& wordFreq) {
+        auto it = wordFreq.find(word);
+        if(it == wordFreq.end()) {
+            COUNT_RESULT_GROWTH;
+            wordFreq.emplace(string(word), 1);
+        } else {
+            it->second++;
         }
     }
     
+    void setCountEmoji(bool enabled) {
+        countEmoji = enabled;
+    }
+    
+    void setQuiet(bool enabled) {
+        quiet = enabled;
+    }
+    
     void displaySentimentStats(const SentimentResult& result) {
         int total = result.positive + result.negative + result.neutral;
         
@@ -184,7 +576,7 @@ public:
         cout << "================================================\n" << endl;
     }
     
-    void generateWordCloud(const map<string, int>& wordFreq, int topN = 20) {
+    void generateWordCloud(const WordCountMap& wordFreq, int topN = 20) {
         vector<WordFreq> words;
         
         for(const auto& pair : wordFreq) {
@@ -203,7 +595,7 @@ public:
         cout << "================================================\n" << endl;
     }
     
-    void generatePosterHTML(const map<string, int>& wordFreq, const string& outputFile, const SentimentResult& result, const string& githubURL) {
+    void generatePosterHTML(const WordCountMap& wordFreq, const string& outputFile, const SentimentResult& result, const string& githubURL) {
         vector<WordFreq> words;
         
         for(const auto& pair : wordFreq) {
@@ -370,12 +762,21 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     cout << "=== Sentiment Analysis & Word Cloud Generator ===" << endl;
     cout << "Converting Excel/CSV data to word cloud...\n" << endl;
     
     SentimentAnalyzer analyzer;
     
+    for(int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if(arg == "--emoji") {
+            analyzer.setCountEmoji(true);
+        } else if(arg == "--quiet") {
+            analyzer.setQuiet(true);
+        }
+    }
+    
     string filename = "survey_data.csv";
     cout << "Reading file: " << filename << endl;
     
@@ -403,5 +804,8 @@ int main() {
     cout << "3. Choose 'Save as PDF' or use browser screenshot tools" << endl;
     cout << "4. Or use online tools to convert the PDF to PNG/JPG" << endl;
     
+#ifdef COUNT_ALLOCATIONS
+    if(g_allocBudgetExceeded) return 1;
+#endif
     return 0;
 }
\ No newline at end of file